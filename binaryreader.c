@@ -74,6 +74,27 @@ typedef signed long long int64;
         (((x)&0x00000000000000FFull) << 56)
 #endif
 
+/*  
+############################################################################
+    SIMD definitions (SSE2 is part of every x64 and most x86 targets)
+############################################################################
+*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BINARYREADER_SSE2
+#if defined(_MSC_VER)
+#include <intrin.h>
+inline static int BinaryReader_ctz(uint32 x)
+{
+    unsigned long index;
+    _BitScanForward(&index, x);
+    return (int)index;
+}
+#else
+#define BinaryReader_ctz(x) __builtin_ctz(x)
+#endif
+#endif
+
 /*  
 ############################################################################
     BinaryReader base class definition
@@ -588,6 +609,995 @@ MAKE_READER_FUNCS(uint64, 8, 64, PyLong_FromUnsignedLongLong, uint64);
 MAKE_READER_FUNCS(float, 4, 32, PyFloat_FromDouble, double);
 MAKE_READER_FUNCS(double, 8, 64, PyFloat_FromDouble, double);
 
+/*  
+############################################################################
+    strided read functions (interleaved channels, e.g. vertex buffers)
+############################################################################
+*/
+
+/* no-op swap for single byte components */
+#define bswap8(x) (x)
+
+/* reinterpret the raw bits of a component as float/double */
+inline static float BinaryReader_bitsToFloat(uint32 bits)
+{
+    float value;
+    memcpy(&value, &bits, 4);
+    return value;
+}
+
+inline static double BinaryReader_bitsToDouble(uint64 bits)
+{
+    double value;
+    memcpy(&value, &bits, 8);
+    return value;
+}
+
+/* convert a half to a float without going through python */
+inline static float BinaryReader_halfToFloat(uint16 half)
+{
+    uint32 sign = (uint32)(half & 0x8000) << 16;
+    uint32 exponent = (half >> 10) & 0x1F;
+    uint32 mantissa = half & 0x3FF;
+    if (exponent == 0x1F)
+    {
+        // inf / nan
+        return BinaryReader_bitsToFloat(sign | 0x7F800000 | (mantissa << 13));
+    }
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            return BinaryReader_bitsToFloat(sign);
+        }
+        // subnormal half -> normalize it for the float
+        exponent = 127 - 15 + 1;
+        while (!(mantissa & 0x400))
+        {
+            mantissa <<= 1;
+            exponent--;
+        }
+        mantissa &= 0x3FF;
+        return BinaryReader_bitsToFloat(sign | (exponent << 23) | (mantissa << 13));
+    }
+    return BinaryReader_bitsToFloat(sign | ((exponent + 127 - 15) << 23) | (mantissa << 13));
+}
+
+/* normalization of integer components to [0, 1] / [-1, 1] */
+#define BinaryReader_unorm8(x) ((float)(x) / 255.0f)
+#define BinaryReader_unorm16(x) ((float)(x) / 65535.0f)
+#define BinaryReader_snorm8(x) (((int8)(x) == -128) ? -1.0f : (float)(int8)(x) / 127.0f)
+#define BinaryReader_snorm16(x) (((int16)(x) == -32768) ? -1.0f : (float)(int16)(x) / 32767.0f)
+
+/* gathers `dimension` components from `count` records, each `stride` bytes apart, into out */
+typedef void (*BinaryReader_StridedDecoder)(const char *src, Py_ssize_t stride, Py_ssize_t count, int dimension, char swap, char *out);
+
+/* strided decoder macro */
+#define MAKE_STRIDED_DECODER(NAME, TYPE_SIZE_BIT, OUT_TYPE, CONVERT)                                                                     \
+    static void BinaryReader__decodeStrided##NAME(const char *src, Py_ssize_t stride, Py_ssize_t count, int dimension, char swap, char *out) \
+    {                                                                                                                                    \
+        OUT_TYPE *dst = (OUT_TYPE *)out;                                                                                                 \
+        uint##TYPE_SIZE_BIT raw;                                                                                                         \
+        if (swap)                                                                                                                        \
+        {                                                                                                                                \
+            for (Py_ssize_t i = 0; i < count; i++, src += stride)                                                                       \
+            {                                                                                                                            \
+                for (int j = 0; j < dimension; j++)                                                                                      \
+                {                                                                                                                        \
+                    memcpy(&raw, src + j * sizeof(raw), sizeof(raw));                                                                    \
+                    *dst++ = CONVERT(bswap##TYPE_SIZE_BIT(raw));                                                                         \
+                }                                                                                                                        \
+            }                                                                                                                            \
+        }                                                                                                                                \
+        else                                                                                                                             \
+        {                                                                                                                                \
+            for (Py_ssize_t i = 0; i < count; i++, src += stride)                                                                       \
+            {                                                                                                                            \
+                for (int j = 0; j < dimension; j++)                                                                                      \
+                {                                                                                                                        \
+                    memcpy(&raw, src + j * sizeof(raw), sizeof(raw));                                                                    \
+                    *dst++ = CONVERT(raw);                                                                                               \
+                }                                                                                                                        \
+            }                                                                                                                            \
+        }                                                                                                                                \
+    }
+
+/* generate decoders via macro */
+MAKE_STRIDED_DECODER(int8, 8, int8, (int8));
+MAKE_STRIDED_DECODER(uint8, 8, uint8, (uint8));
+MAKE_STRIDED_DECODER(int16, 16, int16, (int16));
+MAKE_STRIDED_DECODER(uint16, 16, uint16, (uint16));
+MAKE_STRIDED_DECODER(int32, 32, int32, (int32));
+MAKE_STRIDED_DECODER(uint32, 32, uint32, (uint32));
+MAKE_STRIDED_DECODER(int64, 64, int64, (int64));
+MAKE_STRIDED_DECODER(uint64, 64, uint64, (uint64));
+MAKE_STRIDED_DECODER(half, 16, float, BinaryReader_halfToFloat);
+MAKE_STRIDED_DECODER(float, 32, float, BinaryReader_bitsToFloat);
+MAKE_STRIDED_DECODER(double, 64, double, BinaryReader_bitsToDouble);
+MAKE_STRIDED_DECODER(unorm8, 8, float, BinaryReader_unorm8);
+MAKE_STRIDED_DECODER(snorm8, 8, float, BinaryReader_snorm8);
+MAKE_STRIDED_DECODER(unorm16, 16, float, BinaryReader_unorm16);
+MAKE_STRIDED_DECODER(snorm16, 16, float, BinaryReader_snorm16);
+
+#ifdef BINARYREADER_SSE2
+/* swap the bytes of each uint16 within the vector */
+#define BinaryReader_bswap16x8(v) _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8))
+/* swap the bytes of each uint32 within the vector */
+#define BinaryReader_bswap32x4(v) \
+    _mm_shufflehi_epi16(_mm_shufflelo_epi16(BinaryReader_bswap16x8(v), _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1))
+
+/* SSE2 decoders handle 4 components of a record at once, the rest is done like in the scalar decoders,
+   records with less than 4 components are left to the scalar decoders */
+static void BinaryReader__decodeStridedfloatSSE2(const char *src, Py_ssize_t stride, Py_ssize_t count, int dimension, char swap, char *out)
+{
+    // without a swap the scalar copy is as fast
+    if (dimension < 4 || !swap)
+    {
+        BinaryReader__decodeStridedfloat(src, stride, count, dimension, swap, out);
+        return;
+    }
+    float *dst = (float *)out;
+    int vectorized = dimension & ~3;
+    uint32 raw;
+    for (Py_ssize_t i = 0; i < count; i++, src += stride, dst += dimension)
+    {
+        for (int j = 0; j < vectorized; j += 4)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i *)(src + j * 4));
+            _mm_storeu_si128((__m128i *)(dst + j), BinaryReader_bswap32x4(v));
+        }
+        for (int j = vectorized; j < dimension; j++)
+        {
+            memcpy(&raw, src + j * 4, 4);
+            dst[j] = BinaryReader_bitsToFloat(bswap32(raw));
+        }
+    }
+}
+
+static void BinaryReader__decodeStridedunorm8SSE2(const char *src, Py_ssize_t stride, Py_ssize_t count, int dimension, char swap, char *out)
+{
+    if (dimension < 4)
+    {
+        BinaryReader__decodeStridedunorm8(src, stride, count, dimension, swap, out);
+        return;
+    }
+    float *dst = (float *)out;
+    int vectorized = dimension & ~3;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 max = _mm_set1_ps(255.0f);
+    int32 raw;
+    for (Py_ssize_t i = 0; i < count; i++, src += stride, dst += dimension)
+    {
+        for (int j = 0; j < vectorized; j += 4)
+        {
+            memcpy(&raw, src + j, 4);
+            __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(raw), zero), zero);
+            _mm_storeu_ps(dst + j, _mm_div_ps(_mm_cvtepi32_ps(v), max));
+        }
+        for (int j = vectorized; j < dimension; j++)
+        {
+            dst[j] = BinaryReader_unorm8(((const uint8 *)src)[j]);
+        }
+    }
+}
+
+static void BinaryReader__decodeStridedunorm16SSE2(const char *src, Py_ssize_t stride, Py_ssize_t count, int dimension, char swap, char *out)
+{
+    if (dimension < 4)
+    {
+        BinaryReader__decodeStridedunorm16(src, stride, count, dimension, swap, out);
+        return;
+    }
+    float *dst = (float *)out;
+    int vectorized = dimension & ~3;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 max = _mm_set1_ps(65535.0f);
+    uint16 raw;
+    for (Py_ssize_t i = 0; i < count; i++, src += stride, dst += dimension)
+    {
+        for (int j = 0; j < vectorized; j += 4)
+        {
+            __m128i v = _mm_loadl_epi64((const __m128i *)(src + j * 2));
+            v = _mm_unpacklo_epi16(swap ? BinaryReader_bswap16x8(v) : v, zero);
+            _mm_storeu_ps(dst + j, _mm_div_ps(_mm_cvtepi32_ps(v), max));
+        }
+        for (int j = vectorized; j < dimension; j++)
+        {
+            memcpy(&raw, src + j * 2, 2);
+            dst[j] = BinaryReader_unorm16(swap ? bswap16(raw) : raw);
+        }
+    }
+}
+#define BinaryReader__decodeStridedfloatFast BinaryReader__decodeStridedfloatSSE2
+#define BinaryReader__decodeStridedunorm8Fast BinaryReader__decodeStridedunorm8SSE2
+#define BinaryReader__decodeStridedunorm16Fast BinaryReader__decodeStridedunorm16SSE2
+#else
+#define BinaryReader__decodeStridedfloatFast BinaryReader__decodeStridedfloat
+#define BinaryReader__decodeStridedunorm8Fast BinaryReader__decodeStridedunorm8
+#define BinaryReader__decodeStridedunorm16Fast BinaryReader__decodeStridedunorm16
+#endif
+
+typedef struct
+{
+    const char *name;
+    char size;     // size of a single component within the record
+    char out_code; // memoryview format of the decoded output
+    char out_size; // size of a single decoded component
+    BinaryReader_StridedDecoder decode;
+} BinaryReader_StridedFormat;
+
+static const BinaryReader_StridedFormat BinaryReader_stridedFormats[] = {
+    {"int8", 1, 'b', 1, BinaryReader__decodeStridedint8},
+    {"uint8", 1, 'B', 1, BinaryReader__decodeStrideduint8},
+    {"int16", 2, 'h', 2, BinaryReader__decodeStridedint16},
+    {"uint16", 2, 'H', 2, BinaryReader__decodeStrideduint16},
+    {"int32", 4, 'i', 4, BinaryReader__decodeStridedint32},
+    {"uint32", 4, 'I', 4, BinaryReader__decodeStrideduint32},
+    {"int64", 8, 'q', 8, BinaryReader__decodeStridedint64},
+    {"uint64", 8, 'Q', 8, BinaryReader__decodeStrideduint64},
+    {"half", 2, 'f', 4, BinaryReader__decodeStridedhalf},
+    {"float", 4, 'f', 4, BinaryReader__decodeStridedfloatFast},
+    {"double", 8, 'd', 8, BinaryReader__decodeStrideddouble},
+    {"unorm8", 1, 'f', 4, BinaryReader__decodeStridedunorm8Fast},
+    {"snorm8", 1, 'f', 4, BinaryReader__decodeStridedsnorm8},
+    {"unorm16", 2, 'f', 4, BinaryReader__decodeStridedunorm16Fast},
+    {"snorm16", 2, 'f', 4, BinaryReader__decodeStridedsnorm16},
+    {NULL},
+};
+
+/* records per block when splitting multiple channels, keeps the touched records in cache */
+#define STRIDED_BLOCK_SIZE 1024
+
+static const BinaryReader_StridedFormat *BinaryReader__getStridedFormat(const char *name)
+{
+    for (const BinaryReader_StridedFormat *format = BinaryReader_stridedFormats; format->name; format++)
+    {
+        if (strcmp(format->name, name) == 0)
+        {
+            return format;
+        }
+    }
+    PyErr_Format(PyExc_ValueError, "unknown strided format: %s", name);
+    return NULL;
+}
+
+/* check if a channel is within its stride and if all records can be read */
+static int BinaryReader__checkStrided(BinaryReaderObject *self, const BinaryReader_StridedFormat *format, Py_ssize_t offset, Py_ssize_t stride, Py_ssize_t count, int dimension)
+{
+    if (stride <= 0 || count < 0 || offset < 0 || dimension < 1)
+    {
+        PyErr_SetString(PyExc_ValueError, "stride and dimension have to be positive, offset and count can't be negative");
+        return 1;
+    }
+    // written without sums, so that huge offsets/strides can't overflow
+    if (dimension > stride / format->size)
+    {
+        PyErr_SetString(PyExc_ValueError, "channel exceeds the stride");
+        return 1;
+    }
+    Py_ssize_t channel_size = (Py_ssize_t)format->size * dimension;
+    if (channel_size > stride || offset > stride - channel_size)
+    {
+        PyErr_SetString(PyExc_ValueError, "channel exceeds the stride");
+        return 1;
+    }
+    Py_ssize_t remaining = self->end - self->cur;
+    if (count && (remaining < channel_size || offset > remaining - channel_size || count - 1 > (remaining - offset - channel_size) / stride))
+    {
+        PyErr_SetString(PyExc_ValueError, "read past end of buffer");
+        return 1;
+    }
+    if (count > PY_SSIZE_T_MAX / ((Py_ssize_t)dimension * format->out_size))
+    {
+        PyErr_NoMemory();
+        return 1;
+    }
+    return 0;
+}
+
+/* decode a channel, tightly packed records that don't have to be converted are copied as is */
+inline static void BinaryReader__decodeStridedChannel(const BinaryReader_StridedFormat *format, const char *src, Py_ssize_t stride, Py_ssize_t count, int dimension, char swap, char *out)
+{
+    if (format->size == format->out_size && stride == format->size * dimension && (!swap || format->size == 1))
+    {
+        memcpy(out, src, count * stride);
+    }
+    else
+    {
+        format->decode(src, stride, count, dimension, swap, out);
+    }
+}
+
+/* wrap the decoded data into a memoryview of the given format and shape (count, dimension),
+   1-D for dimension 1, and for count 0 as memoryview can't cast to a shape containing 0 */
+static PyObject *BinaryReader__toTypedView(PyObject *bytearray, char code, Py_ssize_t count, int dimension)
+{
+    PyObject *view = PyMemoryView_FromObject(bytearray);
+    Py_DECREF(bytearray);
+    if (view == NULL)
+    {
+        return NULL;
+    }
+    PyObject *typed;
+    if (dimension > 1 && count > 0)
+    {
+        typed = PyObject_CallMethod(view, "cast", "C(ni)", code, count, dimension);
+    }
+    else
+    {
+        typed = PyObject_CallMethod(view, "cast", "C", code);
+    }
+    Py_DECREF(view);
+    return typed;
+}
+
+/* move the cursor behind the read records */
+inline static void BinaryReader__skipStrided(BinaryReaderObject *self, Py_ssize_t stride, Py_ssize_t count)
+{
+    self->cur = (count > (self->end - self->cur) / stride) ? self->end : self->cur + stride * count;
+}
+
+static PyObject *
+BinaryReader__readStrided(BinaryReaderObject *self, PyObject *args)
+{
+    const char *name;
+    Py_ssize_t offset, stride, count;
+    int dimension = 1;
+    if (!PyArg_ParseTuple(args, "snnn|i", &name, &offset, &stride, &count, &dimension))
+    {
+        return NULL;
+    }
+    const BinaryReader_StridedFormat *format = BinaryReader__getStridedFormat(name);
+    if (format == NULL || BinaryReader__checkStrided(self, format, offset, stride, count, dimension))
+    {
+        return NULL;
+    }
+
+    PyObject *out = PyByteArray_FromStringAndSize(NULL, count * dimension * format->out_size);
+    if (out == NULL)
+    {
+        return NULL;
+    }
+    BinaryReader__decodeStridedChannel(format, self->cur + offset, stride, count, dimension, !self->is_sys_endianess, PyByteArray_AS_STRING(out));
+    BinaryReader__skipStrided(self, stride, count);
+    return BinaryReader__toTypedView(out, format->out_code, count, dimension);
+}
+
+static PyObject *
+BinaryReader__readStridedChannels(BinaryReaderObject *self, PyObject *args)
+{
+    Py_ssize_t stride, count;
+    PyObject *channels;
+    if (!PyArg_ParseTuple(args, "nnO", &stride, &count, &channels))
+    {
+        return NULL;
+    }
+    PyObject *seq = PySequence_Fast(channels, "channels have to be a sequence of (format, offset, dimension)");
+    if (seq == NULL)
+    {
+        return NULL;
+    }
+    Py_ssize_t channel_count = PySequence_Fast_GET_SIZE(seq);
+    const BinaryReader_StridedFormat **formats = PyMem_Malloc(channel_count * sizeof(*formats));
+    Py_ssize_t *offsets = PyMem_Malloc(channel_count * sizeof(*offsets));
+    int *dimensions = PyMem_Malloc(channel_count * sizeof(*dimensions));
+    char **outs = PyMem_Malloc(channel_count * sizeof(*outs));
+    PyObject *result = PyTuple_New(channel_count);
+    if (!formats || !offsets || !dimensions || !outs || !result)
+    {
+        PyErr_NoMemory();
+        goto error;
+    }
+
+    // parse and validate all channels before touching the data
+    for (Py_ssize_t c = 0; c < channel_count; c++)
+    {
+        const char *name;
+        PyObject *channel = PySequence_Tuple(PySequence_Fast_GET_ITEM(seq, c));
+        if (channel == NULL)
+        {
+            goto error;
+        }
+        dimensions[c] = 1;
+        if (!PyArg_ParseTuple(channel, "sn|i", &name, &offsets[c], &dimensions[c]))
+        {
+            Py_DECREF(channel);
+            goto error;
+        }
+        formats[c] = BinaryReader__getStridedFormat(name);
+        Py_DECREF(channel);
+        if (formats[c] == NULL || BinaryReader__checkStrided(self, formats[c], offsets[c], stride, count, dimensions[c]))
+        {
+            goto error;
+        }
+        PyObject *out = PyByteArray_FromStringAndSize(NULL, count * dimensions[c] * formats[c]->out_size);
+        if (out == NULL)
+        {
+            goto error;
+        }
+        PyTuple_SET_ITEM(result, c, out);
+        outs[c] = PyByteArray_AS_STRING(out);
+    }
+
+    // split the records block-wise, so that each record is only pulled into the cache once
+    char swap = !self->is_sys_endianess;
+    for (Py_ssize_t done = 0; done < count; done += STRIDED_BLOCK_SIZE)
+    {
+        Py_ssize_t block = (count - done < STRIDED_BLOCK_SIZE) ? count - done : STRIDED_BLOCK_SIZE;
+        const char *src = self->cur + done * stride;
+        for (Py_ssize_t c = 0; c < channel_count; c++)
+        {
+            BinaryReader__decodeStridedChannel(formats[c], src + offsets[c], stride, block, dimensions[c], swap, outs[c] + done * dimensions[c] * formats[c]->out_size);
+        }
+    }
+    BinaryReader__skipStrided(self, stride, count);
+
+    // convert the raw outputs to typed views
+    for (Py_ssize_t c = 0; c < channel_count; c++)
+    {
+        PyObject *out = PyTuple_GET_ITEM(result, c);
+        Py_INCREF(out);
+        PyObject *typed = BinaryReader__toTypedView(out, formats[c]->out_code, count, dimensions[c]);
+        if (typed == NULL)
+        {
+            goto error;
+        }
+        PyTuple_SetItem(result, c, typed);
+    }
+
+    PyMem_Free(formats);
+    PyMem_Free(offsets);
+    PyMem_Free(dimensions);
+    PyMem_Free(outs);
+    Py_DECREF(seq);
+    return result;
+
+error:
+    PyMem_Free(formats);
+    PyMem_Free(offsets);
+    PyMem_Free(dimensions);
+    PyMem_Free(outs);
+    Py_XDECREF(result);
+    Py_DECREF(seq);
+    return NULL;
+}
+
+/*  
+############################################################################
+    search functions (signatures / patterns within the buffer)
+############################################################################
+*/
+
+/* adds a match to the result, as offset for a single pattern, as (offset, pattern index) for multiple patterns */
+inline static int BinaryReader__addMatch(PyObject *result, Py_ssize_t offset, Py_ssize_t index, char multi)
+{
+    PyObject *match = multi ? Py_BuildValue("(nn)", offset, index) : PyLong_FromSsize_t(offset);
+    if (match == NULL)
+    {
+        return -1;
+    }
+    int ret = PyList_Append(result, match);
+    Py_DECREF(match);
+    return ret;
+}
+
+/* appends all (possibly overlapping) matches within data[start:end] to result, stops after limit matches if limit > 0 */
+static int BinaryReader__search(const char *data, Py_ssize_t start, Py_ssize_t end, Py_buffer *patterns, Py_ssize_t count, char multi, Py_ssize_t limit, PyObject *result)
+{
+    Py_ssize_t found = 0;
+    Py_ssize_t i = start;
+    // filter for the scalar search
+    char first_bytes[256] = {0};
+    for (Py_ssize_t p = 0; p < count; p++)
+    {
+        first_bytes[*(uint8 *)patterns[p].buf] = 1;
+    }
+
+#ifdef BINARYREADER_SSE2
+    // compare the first and last byte of each pattern against 16 positions at once,
+    // only the candidates that match both are compared in full
+    Py_ssize_t max_length = 0;
+    for (Py_ssize_t p = 0; p < count; p++)
+    {
+        max_length = patterns[p].len > max_length ? patterns[p].len : max_length;
+    }
+    uint32 *masks = PyMem_Malloc(count * sizeof(uint32));
+    if (masks == NULL)
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+    // written as subtraction, so that it can't overflow
+    for (; end - i - 15 >= max_length; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        uint32 candidates = 0;
+        for (Py_ssize_t p = 0; p < count; p++)
+        {
+            const char *pattern = patterns[p].buf;
+            __m128i block_last = _mm_loadu_si128((const __m128i *)(data + i + patterns[p].len - 1));
+            __m128i eq_first = _mm_cmpeq_epi8(block, _mm_set1_epi8(pattern[0]));
+            __m128i eq_last = _mm_cmpeq_epi8(block_last, _mm_set1_epi8(pattern[patterns[p].len - 1]));
+            masks[p] = (uint32)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+            candidates |= masks[p];
+        }
+        while (candidates)
+        {
+            int bit = BinaryReader_ctz(candidates);
+            candidates &= candidates - 1;
+            for (Py_ssize_t p = 0; p < count; p++)
+            {
+                if ((masks[p] >> bit) & 1 &&
+                    (patterns[p].len <= 2 || memcmp(data + i + bit + 1, (char *)patterns[p].buf + 1, patterns[p].len - 2) == 0))
+                {
+                    if (BinaryReader__addMatch(result, i + bit, p, multi) < 0)
+                    {
+                        PyMem_Free(masks);
+                        return -1;
+                    }
+                    if (++found == limit)
+                    {
+                        PyMem_Free(masks);
+                        return 0;
+                    }
+                }
+            }
+        }
+    }
+    PyMem_Free(masks);
+#endif
+
+    for (; i < end; i++)
+    {
+        if (!first_bytes[(uint8)data[i]])
+        {
+            continue;
+        }
+        for (Py_ssize_t p = 0; p < count; p++)
+        {
+            if (patterns[p].len <= end - i && memcmp(data + i, patterns[p].buf, patterns[p].len) == 0)
+            {
+                if (BinaryReader__addMatch(result, i, p, multi) < 0)
+                {
+                    return -1;
+                }
+                if (++found == limit)
+                {
+                    return 0;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/* shared implementation of find and findall */
+static PyObject *
+BinaryReader__findImpl(BinaryReaderObject *self, PyObject *args, Py_ssize_t limit)
+{
+    PyObject *pattern;
+    Py_ssize_t start = self->cur - self->data;
+    Py_ssize_t end = self->size;
+    if (!PyArg_ParseTuple(args, "O|nn", &pattern, &start, &end))
+    {
+        return NULL;
+    }
+    // clamp the window to the buffer, like slicing would
+    start = start < 0 ? 0 : (start > self->size ? self->size : start);
+    end = end < start ? start : (end > self->size ? self->size : end);
+
+    // a single pattern or a sequence of patterns
+    char multi = !PyObject_CheckBuffer(pattern);
+    PyObject *seq = multi ? PySequence_Fast(pattern, "Expected bytes-like pattern or a sequence of them") : PyTuple_Pack(1, pattern);
+    if (seq == NULL)
+    {
+        return NULL;
+    }
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    Py_buffer *patterns = PyMem_Calloc(count ? count : 1, sizeof(Py_buffer));
+    Py_ssize_t acquired = 0;
+    PyObject *result = NULL;
+    if (patterns == NULL)
+    {
+        PyErr_NoMemory();
+        goto finally;
+    }
+    for (; acquired < count; acquired++)
+    {
+        if (PyObject_GetBuffer(PySequence_Fast_GET_ITEM(seq, acquired), &patterns[acquired], PyBUF_SIMPLE) < 0)
+        {
+            goto finally;
+        }
+        if (patterns[acquired].len == 0)
+        {
+            acquired++;
+            PyErr_SetString(PyExc_ValueError, "patterns can't be empty");
+            goto finally;
+        }
+    }
+
+    result = PyList_New(0);
+    if (result && count && start < end && BinaryReader__search(self->data, start, end, patterns, count, multi, limit, result) < 0)
+    {
+        Py_CLEAR(result);
+    }
+
+finally:
+    for (Py_ssize_t p = 0; p < acquired; p++)
+    {
+        PyBuffer_Release(&patterns[p]);
+    }
+    PyMem_Free(patterns);
+    Py_DECREF(seq);
+    return result;
+}
+
+static PyObject *
+BinaryReader__findall(BinaryReaderObject *self, PyObject *args)
+{
+    return BinaryReader__findImpl(self, args, 0);
+}
+
+static PyObject *
+BinaryReader__find(BinaryReaderObject *self, PyObject *args)
+{
+    PyObject *matches = BinaryReader__findImpl(self, args, 1);
+    if (matches == NULL)
+    {
+        return NULL;
+    }
+    PyObject *ret;
+    if (PyList_GET_SIZE(matches))
+    {
+        ret = PyList_GET_ITEM(matches, 0);
+        Py_INCREF(ret);
+    }
+    else
+    {
+        // same shape as a match: -1 for a single pattern, (-1, -1) for multiple patterns
+        ret = PyObject_CheckBuffer(PyTuple_GET_ITEM(args, 0)) ? PyLong_FromLong(-1) : Py_BuildValue("(ii)", -1, -1);
+    }
+    Py_DECREF(matches);
+    return ret;
+}
+
+/*  
+############################################################################
+    LazyArray - array view that decodes the elements on access
+############################################################################
+*/
+typedef struct
+{
+    PyObject_HEAD
+        PyObject *base; // LazyArray owning the buffer export, NULL if this one owns it
+    Py_buffer view;     // export of the source object, keeps its buffer alive and fixed in size
+    char *data;         // first element
+    Py_ssize_t length;
+    Py_ssize_t stride; // distance between two elements, negative for reversed slices
+    char typecode;
+    char itemsize;
+    char is_sys_endianess;
+} LazyArrayObject;
+
+static PyTypeObject LazyArrayType;
+
+/* size of the elements of the supported typecodes, 0 for unsupported ones */
+static char LazyArray__itemsize(char typecode)
+{
+    switch (typecode)
+    {
+    case '?':
+    case 'b':
+    case 'B':
+        return 1;
+    case 'h':
+    case 'H':
+    case 'e':
+        return 2;
+    case 'i':
+    case 'I':
+    case 'f':
+        return 4;
+    case 'q':
+    case 'Q':
+    case 'd':
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+/* base has to be the LazyArray owning the buffer export, if NULL the caller has to fill view */
+static LazyArrayObject *LazyArray__new(LazyArrayObject *base, char *data, Py_ssize_t length, Py_ssize_t stride, char typecode, char is_sys_endianess)
+{
+    LazyArrayObject *self = PyObject_New(LazyArrayObject, &LazyArrayType);
+    if (self == NULL)
+    {
+        return NULL;
+    }
+    self->base = (PyObject *)base;
+    Py_XINCREF(base);
+    self->view.obj = NULL;
+    self->data = data;
+    self->length = length;
+    self->stride = stride;
+    self->typecode = typecode;
+    self->itemsize = LazyArray__itemsize(typecode);
+    self->is_sys_endianess = is_sys_endianess;
+    return self;
+}
+
+static void LazyArray_dealloc(LazyArrayObject *self)
+{
+    if (self->base)
+    {
+        Py_DECREF(self->base);
+    }
+    else
+    {
+        PyBuffer_Release(&self->view);
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static Py_ssize_t
+LazyArray_length(LazyArrayObject *self)
+{
+    return self->length;
+}
+
+/* decode a single element, the index has to be within the bounds */
+static PyObject *
+LazyArray__getItem(LazyArrayObject *self, Py_ssize_t i)
+{
+    const char *item = self->data + i * self->stride;
+    uint16 raw16 = 0;
+    uint32 raw32 = 0;
+    uint64 raw64 = 0;
+    switch (self->itemsize)
+    {
+    case 2:
+        memcpy(&raw16, item, 2);
+        raw16 = self->is_sys_endianess ? raw16 : bswap16(raw16);
+        break;
+    case 4:
+        memcpy(&raw32, item, 4);
+        raw32 = self->is_sys_endianess ? raw32 : bswap32(raw32);
+        break;
+    case 8:
+        memcpy(&raw64, item, 8);
+        raw64 = self->is_sys_endianess ? raw64 : bswap64(raw64);
+        break;
+    }
+    switch (self->typecode)
+    {
+    case '?':
+        return PyBool_FromLong(*item);
+    case 'b':
+        return PyLong_FromLong(*(int8 *)item);
+    case 'B':
+        return PyLong_FromLong(*(uint8 *)item);
+    case 'h':
+        return PyLong_FromLong((int16)raw16);
+    case 'H':
+        return PyLong_FromLong(raw16);
+    case 'e':
+        return PyFloat_FromDouble(BinaryReader_halfToFloat(raw16));
+    case 'i':
+        return PyLong_FromLong((int32)raw32);
+    case 'I':
+        return PyLong_FromUnsignedLong(raw32);
+    case 'f':
+        return PyFloat_FromDouble(BinaryReader_bitsToFloat(raw32));
+    case 'q':
+        return PyLong_FromLongLong((int64)raw64);
+    case 'Q':
+        return PyLong_FromUnsignedLongLong(raw64);
+    case 'd':
+        return PyFloat_FromDouble(BinaryReader_bitsToDouble(raw64));
+    }
+    PyErr_SetString(PyExc_SystemError, "invalid LazyArray typecode");
+    return NULL;
+}
+
+static PyObject *
+LazyArray_item(LazyArrayObject *self, Py_ssize_t i)
+{
+    if (i < 0 || i >= self->length)
+    {
+        PyErr_SetString(PyExc_IndexError, "LazyArray index out of range");
+        return NULL;
+    }
+    return LazyArray__getItem(self, i);
+}
+
+static PyObject *
+LazyArray_subscript(LazyArrayObject *self, PyObject *key)
+{
+    if (PyIndex_Check(key))
+    {
+        Py_ssize_t i = PyNumber_AsSsize_t(key, PyExc_IndexError);
+        if (i == -1 && PyErr_Occurred())
+        {
+            return NULL;
+        }
+        return LazyArray_item(self, i < 0 ? i + self->length : i);
+    }
+    if (PySlice_Check(key))
+    {
+        // slices are views on the same data
+        Py_ssize_t start, stop, step;
+        if (PySlice_Unpack(key, &start, &stop, &step) < 0)
+        {
+            return NULL;
+        }
+        Py_ssize_t length = PySlice_AdjustIndices(self->length, &start, &stop, step);
+        LazyArrayObject *base = self->base ? (LazyArrayObject *)self->base : self;
+        return (PyObject *)LazyArray__new(base, self->data + start * self->stride, length, self->stride * step, self->typecode, self->is_sys_endianess);
+    }
+    PyErr_Format(PyExc_TypeError, "LazyArray indices must be integers or slices, not %.200s", Py_TYPE(key)->tp_name);
+    return NULL;
+}
+
+/* copy the elements into a typed memoryview, with the endianess converted to the system one (halfs become floats) */
+static PyObject *
+LazyArray_materialize(LazyArrayObject *self, PyObject *unused)
+{
+    if (self->typecode == 'e')
+    {
+        // memoryview doesn't support half, so they are converted to floats
+        PyObject *out = PyByteArray_FromStringAndSize(NULL, self->length * 4);
+        if (out == NULL)
+        {
+            return NULL;
+        }
+        BinaryReader__decodeStridedhalf(self->data, self->stride, self->length, 1, !self->is_sys_endianess, PyByteArray_AS_STRING(out));
+        return BinaryReader__toTypedView(out, 'f', self->length, 1);
+    }
+    PyObject *out = PyByteArray_FromStringAndSize(NULL, self->length * self->itemsize);
+    if (out == NULL)
+    {
+        return NULL;
+    }
+    char *dst = PyByteArray_AS_STRING(out);
+    const char *src = self->data;
+    if (self->stride == self->itemsize)
+    {
+        memcpy(dst, src, self->length * self->itemsize);
+    }
+    else
+    {
+        for (Py_ssize_t i = 0; i < self->length; i++, src += self->stride, dst += self->itemsize)
+        {
+            memcpy(dst, src, self->itemsize);
+        }
+    }
+    if (!self->is_sys_endianess)
+    {
+        dst = PyByteArray_AS_STRING(out);
+        for (Py_ssize_t i = 0; i < self->length; i++, dst += self->itemsize)
+        {
+            switch (self->itemsize)
+            {
+            case 2:
+                *(uint16 *)dst = bswap16(*(uint16 *)dst);
+                break;
+            case 4:
+                *(uint32 *)dst = bswap32(*(uint32 *)dst);
+                break;
+            case 8:
+                *(uint64 *)dst = bswap64(*(uint64 *)dst);
+                break;
+            }
+        }
+    }
+    return BinaryReader__toTypedView(out, self->typecode, self->length, 1);
+}
+
+static PyObject *
+LazyArray_getTypecode(LazyArrayObject *self, void *closure)
+{
+    return PyUnicode_FromStringAndSize(&self->typecode, 1);
+}
+
+static PySequenceMethods LazyArray_as_sequence = {
+    .sq_length = (lenfunc)LazyArray_length,
+    .sq_item = (ssizeargfunc)LazyArray_item,
+};
+
+static PyMappingMethods LazyArray_as_mapping = {
+    .mp_length = (lenfunc)LazyArray_length,
+    .mp_subscript = (binaryfunc)LazyArray_subscript,
+};
+
+static PyMethodDef LazyArray_methods[] = {
+    {"materialize", (PyCFunction)LazyArray_materialize, METH_NOARGS,
+     PyDoc_STR("copies the elements into a typed memoryview")},
+    {NULL},
+};
+
+static PyGetSetDef LazyArray_getsetters[] = {
+    {"typecode", (getter)LazyArray_getTypecode, NULL, "typecode of the elements", NULL},
+    {NULL} /* Sentinel */
+};
+
+static PyTypeObject LazyArrayType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+        .tp_name = "binaryreader.LazyArray",
+    .tp_doc = "an array view that decodes its elements on access",
+    .tp_basicsize = sizeof(LazyArrayObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_methods = LazyArray_methods,
+    .tp_getset = LazyArray_getsetters,
+    .tp_as_sequence = &LazyArray_as_sequence,
+    .tp_as_mapping = &LazyArray_as_mapping,
+    .tp_dealloc = (destructor)LazyArray_dealloc,
+};
+
+static PyObject *
+BinaryReader__readLazyArray(BinaryReaderObject *self, PyObject *args)
+{
+    int typecode; // "C" stores an int
+    PyObject *length_obj = Py_None;
+    Py_ssize_t length;
+    if (!PyArg_ParseTuple(args, "C|O", &typecode, &length_obj))
+    {
+        return NULL;
+    }
+    char itemsize = typecode < 128 ? LazyArray__itemsize((char)typecode) : 0;
+    if (!itemsize)
+    {
+        PyErr_Format(PyExc_ValueError, "unsupported typecode: %c", typecode);
+        return NULL;
+    }
+    // the cursor is only moved if the whole array can be read
+    char *cur = self->cur;
+    if (length_obj == Py_None)
+    {
+        if (BinaryReader_checkReadLength(self, 4))
+        {
+            return NULL;
+        }
+        length = (int32)BinaryReader_convertEndian32(self, *(uint32 *)cur);
+        cur += 4;
+    }
+    else
+    {
+        length = PyNumber_AsSsize_t(length_obj, PyExc_OverflowError);
+        if (length == -1 && PyErr_Occurred())
+        {
+            return NULL;
+        }
+    }
+    if (length < 0 || length > (self->end - cur) / itemsize)
+    {
+        PyErr_SetString(PyExc_ValueError, length < 0 ? "negative array length" : "read past end of buffer");
+        return NULL;
+    }
+    LazyArrayObject *array = LazyArray__new(NULL, NULL, length, itemsize, typecode, self->is_sys_endianess);
+    if (array == NULL)
+    {
+        return NULL;
+    }
+    // export the buffer, so that it can't be freed or resized while the array exists
+    if (PyObject_GetBuffer(self->obj, &array->view, PyBUF_SIMPLE) < 0)
+    {
+        Py_DECREF(array);
+        return NULL;
+    }
+    Py_ssize_t offset = cur - self->data;
+    if (offset + length * itemsize > array->view.len)
+    {
+        PyErr_SetString(PyExc_ValueError, "read past end of buffer");
+        Py_DECREF(array);
+        return NULL;
+    }
+    array->data = (char *)array->view.buf + offset;
+    self->cur = cur + length * itemsize;
+    return (PyObject *)array;
+}
+
 /*  
 ############################################################################
     add read functions to BinaryReaderObject as methods
@@ -661,6 +1671,16 @@ static PyMethodDef BinaryReader_methods[] = {
      PyDoc_STR("reads a varint")},
     {"readLSB", (PyCFunction)BinaryReader__readLSB, METH_VARARGS,
      PyDoc_STR("reads the lsb data of the given size (in bytes to read -> output length is 1/8 of that)")},
+    {"readStrided", (PyCFunction)BinaryReader__readStrided, METH_VARARGS,
+     PyDoc_STR("reads a channel of count interleaved records into a typed memoryview of shape (count, dimension), or (count,) if dimension is 1 or count is 0")},
+    {"readStridedChannels", (PyCFunction)BinaryReader__readStridedChannels, METH_VARARGS,
+     PyDoc_STR("reads multiple (format, offset, dimension) channels of interleaved records in a single pass")},
+    {"find", (PyCFunction)BinaryReader__find, METH_VARARGS,
+     PyDoc_STR("returns the offset of the first match of the pattern(s) within [start, end), -1 if not found")},
+    {"findall", (PyCFunction)BinaryReader__findall, METH_VARARGS,
+     PyDoc_STR("returns the offsets of all matches of the pattern(s) within [start, end)")},
+    {"readLazyArray", (PyCFunction)BinaryReader__readLazyArray, METH_VARARGS,
+     PyDoc_STR("reads an array of the given typecode as LazyArray, which decodes the elements on access")},
     {NULL},
 };
 
@@ -697,6 +1717,8 @@ PyInit_binaryreader(void)
     PyObject *m;
     if (PyType_Ready(&BinaryReaderType) < 0)
         return NULL;
+    if (PyType_Ready(&LazyArrayType) < 0)
+        return NULL;
 
     m = PyModule_Create(&BinaryReadermodule);
     if (m == NULL)
@@ -710,5 +1732,13 @@ PyInit_binaryreader(void)
         return NULL;
     }
 
+    Py_INCREF(&LazyArrayType);
+    if (PyModule_AddObject(m, "LazyArray", (PyObject *)&LazyArrayType) < 0)
+    {
+        Py_DECREF(&LazyArrayType);
+        Py_DECREF(m);
+        return NULL;
+    }
+
     return m;
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 from struct import unpack_from, Struct, unpack, pack
+import pytest
 from binaryreader import BinaryReader
 
 TESTS = [
@@ -102,6 +103,179 @@ def test_lsb():
     assert br_value == value
 
 
+def test_strided():
+    # position (3 float), normal (3 half), uv (2 unorm16), color (4 unorm8)
+    vertices = [
+        ((i, i + 0.5, -i), (0.5, -1.0, 2.0), (i * 1000, 65535), (i, 255, 0, 51))
+        for i in range(10)
+    ]
+    for endian in ["<", ">"]:
+        vertex = Struct(endian + "3f3e2H4B")
+        data = b"".join(vertex.pack(*p, *n, *uv, *c) for p, n, uv, c in vertices)
+        br = BinaryReader(data, endian == "<")
+        positions = br.readStrided("float", 0, vertex.size, len(vertices), 3)
+        assert br.position == vertex.size * len(vertices)
+        assert positions.tolist() == [list(p) for p, _, _, _ in vertices]
+
+        br.position = 0
+        normals, uvs, colors = br.readStridedChannels(
+            vertex.size,
+            len(vertices),
+            [("half", 12, 3), ("unorm16", 18, 2), ("unorm8", 22, 4)],
+        )
+        assert normals.tolist() == [list(n) for _, n, _, _ in vertices]
+        assert uvs.tolist() == [pytest.approx([x / 65535 for x in uv]) for _, _, uv, _ in vertices]
+        assert colors.tolist() == [pytest.approx([x / 255 for x in c]) for _, _, _, c in vertices]
+
+        br.position = 0
+        with pytest.raises(ValueError):
+            br.readStrided("float", 0, vertex.size, len(vertices) + 1, 3)
+
+
+def test_strided_formats():
+    # weight (snorm16), bone index (int16), time (double) and padding
+    records = [((-32768, -16384, 32767), -i, i / 3) for i in range(10)]
+    for endian in ["<", ">"]:
+        record = Struct(endian + "3hhd4x")
+        data = b"".join(record.pack(*w, b, t) for w, b, t in records)
+        br = BinaryReader(data, endian == "<")
+        weights, bones, times = br.readStridedChannels(
+            record.size,
+            len(records),
+            [["snorm16", 0, 3], ("int16", 6), ("double", 8, 1)],
+        )
+        assert weights.tolist() == [pytest.approx([-1.0, -16384 / 32767, 1.0])] * len(records)
+        assert bones.tolist() == [b for _, b, _ in records]
+        assert times.tolist() == [t for _, _, t in records]
+
+
+def test_strided_vectorized():
+    # channels with 4+ components use the vectorized decoders, with a scalar tail
+    records = [([i + 0.25 * j for j in range(6)], [i * 1000 + j for j in range(5)]) for i in range(10)]
+    for endian in ["<", ">"]:
+        record = Struct(endian + "6f5H2x")
+        data = b"".join(record.pack(*f, *u) for f, u in records)
+        br = BinaryReader(data, endian == "<")
+        floats, unorms = br.readStridedChannels(record.size, len(records), [("float", 0, 6), ("unorm16", 24, 5)])
+        assert floats.tolist() == [f for f, _ in records]
+        assert unorms.tolist() == [pytest.approx([x / 65535 for x in u]) for _, u in records]
+
+
+def test_strided_bounds():
+    br = BinaryReader(b"\x00" * 64, True)
+    br.position = 8
+    huge = 2**63 - 1
+    for offset, stride, count in [
+        (huge, huge, 1),
+        (huge - 1, huge, 1),
+        (0, huge, 2),
+        (2, 64, huge),
+        (60, 62, 2),
+    ]:
+        # rejected reads don't move the cursor
+        with pytest.raises(ValueError):
+            br.readStrided("uint16", offset, stride, count)
+        assert br.position == 8
+        with pytest.raises(ValueError):
+            br.readStridedChannels(stride, count, [("uint16", offset, 1)])
+        assert br.position == 8
+    with pytest.raises(ValueError):
+        br.readStrided("uint16", 0, 4, 1, 2**31 - 1)
+    assert br.position == 8
+    assert br.readStrided("uint16", 0, 4, 3).shape == (3,)
+    assert br.readStrided("uint16", 0, 4, 3, 2).shape == (3, 2)
+    assert br.readStrided("uint16", 0, 4, 0, 2).shape == (0,)
+
+
+def test_find():
+    data = b"\x00" * 40 + b"UnityFS" + b"\x00" * 20 + b"\x89PNG" + b"RIFF" + b"\x00" * 30 + b"UnityFS"
+    br = BinaryReader(data, True)
+    assert br.find(b"UnityFS") == 40
+    assert br.find(b"UnityFS", 41) == data.find(b"UnityFS", 41)
+    assert br.find(b"UnityFS", 41, 60) == -1
+    assert br.findall(b"UnityFS") == [40, data.rfind(b"UnityFS")]
+    assert br.findall((b"\x89PNG", b"RIFF", b"UnityFS")) == [
+        (40, 2),
+        (data.find(b"\x89PNG"), 0),
+        (data.find(b"RIFF"), 1),
+        (data.rfind(b"UnityFS"), 2),
+    ]
+    assert br.find((b"RIFF", b"\x89PNG"), 41) == (data.find(b"\x89PNG"), 1)
+    assert br.find((b"OggS",)) == (-1, -1)
+    # the search starts at the cursor by default and doesn't move it
+    br.position = 41
+    assert br.find(b"UnityFS") == data.rfind(b"UnityFS")
+    assert br.position == 41
+
+
+def test_find_bounds():
+    data = b"\x00" * 30 + b"ab" + b"\x00" * 32
+    br = BinaryReader(data, True)
+    huge = 2**63 - 10
+    assert br.find(b"ab", huge) == -1
+    assert br.find(b"ab", huge, huge + 5) == -1
+    assert br.findall((b"ab", b"\x00"), huge) == []
+    assert br.find(b"ab", -huge, huge) == 30
+    assert br.find(b"ab", 40, 10) == -1
+    assert br.find(b"ab", 0, -huge) == -1
+    assert br.findall(b"ab", 0, 31) == []
+    assert br.findall(b"ab", 0, 32) == [30]
+
+
+def test_lazy_array():
+    array = [(16**i) % 127 - 64 for i in range(100)]
+    for endian in ["<", ">"]:
+        data = Struct(endian + "i").pack(len(array))
+        data += Struct(endian + "h" * len(array)).pack(*array)
+        data += b"\x01"
+        br = BinaryReader(data, endian == "<")
+        lazy = br.readLazyArray("h")
+        # the cursor is moved behind the array
+        assert br.readUInt8() == 1
+        assert len(lazy) == len(array)
+        assert lazy[5] == array[5]
+        assert lazy[-1] == array[-1]
+        assert list(lazy) == array
+        assert list(lazy[10:50:3]) == array[10:50:3]
+        assert list(lazy[::-1][5:20]) == array[::-1][5:20]
+        assert lazy[10:50:3].materialize().tolist() == array[10:50:3]
+        with pytest.raises(IndexError):
+            lazy[len(array)]
+
+    br = BinaryReader(Struct("<i").pack(10) + b"\x00" * 8, True)
+    with pytest.raises(ValueError):
+        br.readLazyArray("h")
+    assert br.position == 0
+    with pytest.raises(ValueError):
+        br.readLazyArray("h", None)
+    assert br.position == 0
+
+    # passing the length skips the length prefix, None reads it
+    br = BinaryReader(Struct("<i3h").pack(3, 7, 8, 9), True)
+    assert list(br.readLazyArray("h", None)) == [7, 8, 9]
+    br.position = 4
+    assert list(br.readLazyArray("h", 2)) == [7, 8]
+    assert br.position == 8
+    with pytest.raises(ValueError):
+        br.readLazyArray("\u0168")
+
+
+def test_lazy_array_keeps_buffer():
+    data = bytearray(Struct("<i10h").pack(10, *range(10)))
+    br = BinaryReader(data, True)
+    lazy = br.readLazyArray("h")
+    view = lazy[::2]
+    del lazy
+    # the array and its slices export the buffer, so the source can't be resized
+    with pytest.raises(BufferError):
+        data.extend(b"\x00" * 10_000_000)
+    with pytest.raises(BufferError):
+        del data[:]
+    assert list(view) == list(range(0, 10, 2))
+    del view
+    data.extend(b"\x00")
+
+
 def run_tests():
     print("Running tests")
     for key, value in list(globals().items()):